@@ -46,6 +46,7 @@ public class KinectUE4 : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"Projects",
 				"Slate",
 				"SlateCore",
 				// ... add private dependencies that you statically link with here ...	
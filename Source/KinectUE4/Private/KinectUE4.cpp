@@ -1,5 +1,16 @@
 // Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
 #include "KinectUE4.h"
+#include "Stats/Stats.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Async/ParallelFor.h"
+#include "Misc/ScopeRWLock.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Interfaces/IPluginManager.h"
 
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN             // Exclude rarely-used stuff from Windows headers
@@ -17,6 +28,241 @@ static_assert(FKinectJoint::TypeCount == JointType_Count, "invalid JointType_Cou
 
 #define LOCTEXT_NAMESPACE "FKinectUE4Module"
 
+DECLARE_STATS_GROUP(TEXT("KinectUE4"), STATGROUP_KinectUE4, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("AcquireLatestBodyFrame"), STAT_KinectAcquireBodyFrame, STATGROUP_KinectUE4);
+DECLARE_CYCLE_STAT(TEXT("Convert Joints"), STAT_KinectConvertJoints, STATGROUP_KinectUE4);
+DECLARE_CYCLE_STAT(TEXT("Gesture Results"), STAT_KinectGestureResults, STATGROUP_KinectUE4);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tracked Bodies"), STAT_KinectTrackedBodies, STATGROUP_KinectUE4);
+
+static TAutoConsoleVariable<int32> CVarKinectParallelBodies(
+  TEXT("Kinect.ParallelBodies"),
+  1,
+  TEXT("0: acquire bodies one after another, 1: acquire each body as a task when gestures are acquired"));
+
+static TAutoConsoleVariable<float> CVarKinectMaxExtrapolationSeconds(
+  TEXT("Kinect.MaxExtrapolationSeconds"),
+  0.05f,
+  TEXT("How far past the newest body frame SampleBodyPoses may extrapolate, in seconds"));
+
+// Camera space is right-handed (x left-to-right, y up, z forward), UE4 is left-handed (x forward, y right, z up).
+// The axis swap mirrors, so rotation axes also flip sign.
+static void ConvertJoints(const Joint (&joints)[JointType_Count], const JointOrientation (&orientations)[JointType_Count],
+                          FKinectJoint (&out_joints)[FKinectJoint::TypeCount]) {
+  for (int j = 0; j < JointType_Count; ++j) {
+    const auto& joint = joints[j];
+    const auto& orientation = orientations[j].Orientation;
+    auto& wrapped_joint = out_joints[j];
+    wrapped_joint.type = static_cast<decltype(wrapped_joint.type)>(joint.JointType);
+    wrapped_joint.trackingState = static_cast<decltype(wrapped_joint.trackingState)>(joint.TrackingState);
+    wrapped_joint.location = FVector(joint.Position.Z, -joint.Position.X, joint.Position.Y) * 100.f;
+    wrapped_joint.orientation = FQuat(-orientation.z, orientation.x, -orientation.y, orientation.w);
+  }
+}
+
+static void CopyBodyPoses(const FKinectBody (&bodies)[FKinectBody::Count], FKinectBodyPose (&out_poses)[FKinectBody::Count]) {
+  for (int i = 0; i < FKinectBody::Count; ++i) {
+    const auto& body = bodies[i];
+    auto& pose = out_poses[i];
+    pose.bValid = body.bValid;
+    pose.trackingId = body.trackingId;
+    if (body.bValid) {
+      std::copy(std::begin(body.joints), std::end(body.joints), std::begin(pose.joints));
+    }
+  }
+}
+
+// Recordings start with BodyFrameRecordingHeader, then one line per tracked body: "<frame> <body>" followed by
+// "<state> <x> <y> <z> <qx> <qy> <qz> <qw>" for every joint, in camera space.
+static const TCHAR* BodyFrameRecordingHeader = TEXT("# KinectUE4BodyFrames 2");
+
+static void AppendRecordedJoints(FString& recording, uint32 frameIndex, int bodyIndex, const Joint (&joints)[JointType_Count],
+                                 const JointOrientation (&orientations)[JointType_Count]) {
+  recording += FString::Printf(TEXT("%u %d"), frameIndex, bodyIndex);
+  for (int j = 0; j < JointType_Count; ++j) {
+    const auto& joint = joints[j];
+    const auto& orientation = orientations[j].Orientation;
+    recording += FString::Printf(TEXT(" %d %f %f %f %f %f %f %f"), (int)joint.TrackingState,
+                                 joint.Position.X, joint.Position.Y, joint.Position.Z,
+                                 orientation.x, orientation.y, orientation.z, orientation.w);
+  }
+  recording += LINE_TERMINATOR;
+}
+
+/**
+ * The sensor calls made by AcquireLatestBodyFrame, so the same per-body code runs against the Kinect
+ * (FKinectSensorBodyFrameSource) or the fake source used by RunBodyFrameBenchmark.
+ * Per-body calls are made from one task per body.
+ */
+class IKinectBodyFrameSource {
+public:
+  virtual ~IKinectBodyFrameSource() = default;
+
+  virtual HRESULT AcquireLatestFrame(TIMESPAN& out_relativeTime) = 0;
+  virtual HRESULT GetIsTracked(int bodyIndex, bool& out_bTracked) = 0;
+  virtual HRESULT GetTrackingId(int bodyIndex, UINT64& out_trackingId) = 0;
+  virtual HRESULT GetJoints(int bodyIndex, Joint (&out_joints)[JointType_Count],
+                            JointOrientation (&out_orientations)[JointType_Count]) = 0;
+  /** Points the body's gesture source at trackingId and calculates its gesture frame, E_PENDING until one is ready. */
+  virtual HRESULT AcquireGestureFrame(int bodyIndex, UINT64 trackingId, bool& out_bTrackingIdValid) = 0;
+  virtual HRESULT GetGestureType(UINT gestureIndex, GestureType& out_type) = 0;
+  virtual HRESULT GetGestureName(UINT gestureIndex, wchar_t (&out_name)[260]) = 0;
+  virtual HRESULT GetDiscreteGestureResult(int bodyIndex, UINT gestureIndex, bool& out_bDetected, float& out_confidence) = 0;
+};
+
+class FKinectSensorBodyFrameSource : public IKinectBodyFrameSource {
+public:
+  explicit FKinectSensorBodyFrameSource(FKinectUE4Module& module) :
+    _module(module)
+  {
+  }
+
+  virtual HRESULT AcquireLatestFrame(TIMESPAN& out_relativeTime) override {
+    TKinectComPtr<IBodyFrame> bodyFrame = nullptr;
+    HRESULT hr = _module._bodyFrameReader->AcquireLatestFrame(&bodyFrame);
+    if (hr == E_PENDING) {
+      return hr;
+    } else if (FAILED(hr)) {
+      UE_LOG(LogTemp, Error, TEXT("FAILED(_bodyFrameReader->AcquireLatestFrame(&bodyFrame))"));
+      return hr;
+    }
+    hr = bodyFrame->get_RelativeTime(&out_relativeTime);
+    if (FAILED(hr)) {
+      UE_LOG(LogTemp, Error, TEXT("FAILED(bodyFrame->get_RelativeTime(&relativeTime))"));
+      return hr;
+    }
+    IBody* tmp_bodies[BODY_COUNT] = { nullptr };
+    hr = bodyFrame->GetAndRefreshBodyData(BODY_COUNT, tmp_bodies);
+    if (FAILED(hr)) {
+      UE_LOG(LogTemp, Error, TEXT("FAILED(bodyFrame->GetAndRefreshBodyData(BODY_COUNT, tmp_bodies))"));
+      return hr;
+    }
+    for (int i = 0; i < BODY_COUNT; ++i) {
+      _bodies[i] = tmp_bodies[i];
+    }
+    return S_OK;
+  }
+
+  virtual HRESULT GetIsTracked(int bodyIndex, bool& out_bTracked) override {
+    out_bTracked = false;
+    if (!_bodies[bodyIndex]) {
+      return S_OK;
+    }
+    BOOLEAN bTracked = false;
+    HRESULT hr = _bodies[bodyIndex]->get_IsTracked(&bTracked);
+    if (FAILED(hr)) {
+      UE_LOG(LogTemp, Error, TEXT("FAILED(body->get_IsTracked(&bTracked))"));
+      return hr;
+    }
+    out_bTracked = (bool)bTracked;
+    return S_OK;
+  }
+
+  virtual HRESULT GetTrackingId(int bodyIndex, UINT64& out_trackingId) override {
+    HRESULT hr = _bodies[bodyIndex]->get_TrackingId(&out_trackingId);
+    if (FAILED(hr)) {
+      UE_LOG(LogTemp, Error, TEXT("FAILED(body->get_TrackingId(&trackingId))"));
+    }
+    return hr;
+  }
+
+  virtual HRESULT GetJoints(int bodyIndex, Joint (&out_joints)[JointType_Count],
+                            JointOrientation (&out_orientations)[JointType_Count]) override {
+    const auto& body = _bodies[bodyIndex];
+    HRESULT hr = body->GetJoints(JointType_Count, out_joints);
+    if (FAILED(hr)) {
+      UE_LOG(LogTemp, Error, TEXT("FAILED(body->GetJoints(JointType_Count, joints))"));
+      return hr;
+    }
+    hr = body->GetJointOrientations(JointType_Count, out_orientations);
+    if (FAILED(hr)) {
+      UE_LOG(LogTemp, Error, TEXT("FAILED(body->GetJointOrientations(JointType_Count, jointOrientations))"));
+    }
+    return hr;
+  }
+
+  virtual HRESULT AcquireGestureFrame(int bodyIndex, UINT64 trackingId, bool& out_bTrackingIdValid) override {
+    out_bTrackingIdValid = false;
+    const auto& gestureSource = _module._gestureSources[bodyIndex];
+    UINT64 gestureId = _UI64_MAX;
+    HRESULT hr = gestureSource->get_TrackingId(&gestureId);
+    if (FAILED(hr)) {
+      UE_LOG(LogTemp, Error, TEXT("FAILED(_gestureSources[bodyIndex]->get_TrackingId(&gestureId))"));
+      return hr;
+    }
+    if (trackingId != gestureId) {
+      hr = gestureSource->put_TrackingId(trackingId);
+      if (FAILED(hr)) {
+        UE_LOG(LogTemp, Error, TEXT("FAILED(_gestureSources[bodyIndex]->put_TrackingId(trackingId))"));
+        return hr;
+      }
+      UE_LOG(LogTemp, Error, TEXT("Put TrackingId: %llu"), trackingId);
+    }
+    auto& gestureFrame = _gestureFrames[bodyIndex];
+    gestureFrame.Reset();
+    hr = _module._gestureReaders[bodyIndex]->CalculateAndAcquireLatestFrame(&gestureFrame);
+    if (hr == E_PENDING) {
+      return hr;
+    } else if (FAILED(hr)) {
+      UE_LOG(LogTemp, Error, TEXT("FAILED(_gestureReaders[bodyIndex]->CalculateAndAcquireLatestFrame(&gestureFrame))"));
+      return hr;
+    }
+    BOOLEAN bGestureTracked = false;
+    hr = gestureFrame->get_IsTrackingIdValid(&bGestureTracked);
+    if (FAILED(hr)) {
+      UE_LOG(LogTemp, Error, TEXT("FAILED(gestureFrame->get_IsTrackingIdValid(&bGestureTracked))"));
+      return hr;
+    }
+    out_bTrackingIdValid = (bool)bGestureTracked;
+    return S_OK;
+  }
+
+  virtual HRESULT GetGestureType(UINT gestureIndex, GestureType& out_type) override {
+    HRESULT hr = _module._gestures[gestureIndex]->get_GestureType(&out_type);
+    if (FAILED(hr)) {
+      UE_LOG(LogTemp, Error, TEXT("FAILED(_gestures[gestureIdx]->get_GestureType(&gestureType))"));
+    }
+    return hr;
+  }
+
+  virtual HRESULT GetGestureName(UINT gestureIndex, wchar_t (&out_name)[260]) override {
+    HRESULT hr = _module._gestures[gestureIndex]->get_Name(260, out_name);
+    if (FAILED(hr)) {
+      UE_LOG(LogTemp, Error, TEXT("FAILED(_gestures[gestureIdx]->get_Name(260, gestureName))"));
+    }
+    return hr;
+  }
+
+  virtual HRESULT GetDiscreteGestureResult(int bodyIndex, UINT gestureIndex, bool& out_bDetected, float& out_confidence) override {
+    out_bDetected = false;
+    out_confidence = 0.f;
+    TKinectComPtr<IDiscreteGestureResult> gestureResult = nullptr;
+    HRESULT hr = _gestureFrames[bodyIndex]->get_DiscreteGestureResult(_module._gestures[gestureIndex].Get(), &gestureResult);
+    if (FAILED(hr)) {
+      UE_LOG(LogTemp, Error, TEXT("FAILED(gestureFrame->get_DiscreteGestureResult(_gestures[gestureIdx], &gestureResult))"));
+      return hr;
+    }
+    BOOLEAN detected = false;
+    hr = gestureResult->get_Detected(&detected);
+    if (FAILED(hr)) {
+      UE_LOG(LogTemp, Error, TEXT("FAILED(gestureResult->get_Detected(&detected))"));
+      return hr;
+    }
+    out_bDetected = (bool)detected;
+    if (detected) {
+      hr = gestureResult->get_Confidence(&out_confidence);
+      if (FAILED(hr)) {
+        UE_LOG(LogTemp, Error, TEXT("FAILED(gestureResult->get_Confidence(&confidence))"));
+      }
+    }
+    return hr;
+  }
+
+private:
+  FKinectUE4Module& _module;
+  TKinectComPtr<IBody> _bodies[BODY_COUNT];
+  TKinectComPtr<IVisualGestureBuilderFrame> _gestureFrames[BODY_COUNT];
+};
+
 void FKinectUE4Module::StartupModule() {
   //InstallKinect();
 }
@@ -111,14 +357,10 @@ void FKinectUE4Module::StartupKinect(const FString& gdbFilePath) {
   
   _kinectSensor = MoveTemp(kinectSensor);
   _bodyFrameReader = MoveTemp(bodyFrameReader);
-  _numOfGestures = numOfGestures;
   std::copy_n(std::begin(gestures), numOfGestures, std::begin(_gestures));
   std::copy(std::begin(gestureSources), std::end(gestureSources), std::begin(_gestureSources));
   std::copy(std::begin(gestureReaders), std::end(gestureReaders), std::begin(_gestureReaders));
-
-  for (int i = 0; i < BODY_COUNT; ++i) {
-    _bodies[i].gestures.SetNum(numOfGestures, true);
-  }
+  InstallBodyFrameSource(MakeShared<FKinectSensorBodyFrameSource>(*this), numOfGestures);
 
   bKinectStartup = true;
 }
@@ -131,11 +373,17 @@ void FKinectUE4Module::ShutdownKinect() {
     return;
   }
 
+  _bodyFrameSource.Reset();
   for (UINT i = 0; i < _numOfGestures; ++i) {
     _gestures[i].Reset();
   }
   _numOfGestures = 0;
 
+  {
+    FRWScopeLock lock(_poseFramesLock, SLT_Write);
+    _numOfPoseFrames = 0;
+  }
+
   for (int i = 0; i < BODY_COUNT; ++i) {
     _gestureSources[i].Reset();
     _gestureReaders[i].Reset();
@@ -205,147 +453,573 @@ void FKinectUE4Module::ShutdownKinect() {
 //}
 
 bool FKinectUE4Module::AcquireLatestBodyFrame(FKinectBody*& out_bodies, bool bAcquireJoint, bool bAcquireGesture) {
-  if (!_bodyFrameReader) {
+  SCOPE_CYCLE_COUNTER(STAT_KinectAcquireBodyFrame);
+  IKinectBodyFrameSource* source = _bodyFrameSource.Get();
+  if (!source) {
     return false;
   }
 
-  TKinectComPtr<IBodyFrame> bodyFrame = nullptr;
-  TKinectComPtr<IBody> bodies[BODY_COUNT] = { nullptr };
-  HRESULT hr = _bodyFrameReader->AcquireLatestFrame(&bodyFrame);
-  if (hr == E_PENDING) {
+  TIMESPAN relativeTime = 0;
+  HRESULT hr = source->AcquireLatestFrame(relativeTime);
+  if (FAILED(hr)) { // including E_PENDING
     return false;
+  }
+  const double engineTime = FPlatformTime::Seconds();
+
+  // Bodies only share read-only gesture definitions, so each one runs as its own task. Joint conversion alone
+  // is cheaper than dispatching it; the gesture readers are what is worth spreading out.
+  FString recordings[BODY_COUNT];
+  const int32 parallelBodies = _parallelBodies >= 0 ? _parallelBodies : CVarKinectParallelBodies.GetValueOnAnyThread();
+  const bool bSingleThread = !bAcquireGesture || parallelBodies == 0;
+  ParallelFor(BODY_COUNT, [&](int32 i) {
+    auto& wrapped_body = _bodies[i];
+    wrapped_body.status = AcquireBody(*source, i, bAcquireJoint, bAcquireGesture,
+                                      bRecordingBodyFrames ? &recordings[i] : nullptr);
+    if (wrapped_body.status == FKinectBodyStatus::Failed) {
+      wrapped_body.bValid = false;
+    }
+  }, bSingleThread);
+
+  uint32 numOfTrackedBodies = 0;
+  for (int i = 0; i < BODY_COUNT; ++i) {
+    if (_bodies[i].bValid) {
+      ++numOfTrackedBodies;
+    }
+  }
+  SET_DWORD_STAT(STAT_KinectTrackedBodies, numOfTrackedBodies);
+  if (bRecordingBodyFrames) {
+    for (const FString& recording : recordings) {
+      _bodyFrameRecording += recording;
+    }
+    ++_numOfRecordedFrames;
+  }
+  if (bAcquireJoint) {
+    PublishPoseFrame(relativeTime * 1e-7, engineTime);
+  }
+  out_bodies = _bodies;
+  return true;
+}
+
+FKinectBodyStatus FKinectUE4Module::AcquireBody(IKinectBodyFrameSource& source, int bodyIndex, bool bAcquireJoint,
+                                                bool bAcquireGesture, FString* out_recording) {
+  auto& wrapped_body = _bodies[bodyIndex];
+  bool bTracked = false;
+  if (FAILED(source.GetIsTracked(bodyIndex, bTracked))) {
+    return FKinectBodyStatus::Failed;
+  }
+  wrapped_body.bValid = bTracked;
+  if (!bTracked) {
+    return FKinectBodyStatus::Ok;
+  }
+  UINT64 trackingId = _UI64_MAX;
+  if (FAILED(source.GetTrackingId(bodyIndex, trackingId))) {
+    return FKinectBodyStatus::Failed;
+  }
+  if (wrapped_body.trackingId != trackingId) {
+    // Another person took this slot; the previous results must not outlive them while the reader is pending.
+    for (UINT gestureIdx = 0; gestureIdx < _numOfGestures; ++gestureIdx) {
+      wrapped_body.gestures[gestureIdx].Reset();
+    }
+  }
+  wrapped_body.trackingId = trackingId;
+  if (bAcquireJoint) { // Joint
+    Joint joints[JointType_Count];
+    JointOrientation jointOrientations[JointType_Count];
+    if (FAILED(source.GetJoints(bodyIndex, joints, jointOrientations))) {
+      return FKinectBodyStatus::Failed;
+    }
+    {
+      SCOPE_CYCLE_COUNTER(STAT_KinectConvertJoints);
+      ConvertJoints(joints, jointOrientations, wrapped_body.joints);
+    }
+    if (out_recording) {
+      AppendRecordedJoints(*out_recording, _numOfRecordedFrames, bodyIndex, joints, jointOrientations);
+    }
+  }
+  if (!bAcquireGesture) {
+    return FKinectBodyStatus::Ok;
+  }
+
+  // Gesture
+  SCOPE_CYCLE_COUNTER(STAT_KinectGestureResults);
+  bool bGestureTracked = false;
+  HRESULT hr = source.AcquireGestureFrame(bodyIndex, trackingId, bGestureTracked);
+  if (hr == E_PENDING) {
+    return FKinectBodyStatus::Pending;
   } else if (FAILED(hr)) {
-    UE_LOG(LogTemp, Error, TEXT("FAILED(_bodyFrameReader->AcquireLatestFrame(&bodyFrame))"));
+    return FKinectBodyStatus::GestureFailed;
+  }
+  // Only clear once there is a new gesture frame, so a Pending body keeps reporting the results of the same person.
+  for (UINT gestureIdx = 0; gestureIdx < _numOfGestures; ++gestureIdx) {
+    wrapped_body.gestures[gestureIdx].Reset();
+  }
+  if (!bGestureTracked) {
+    return FKinectBodyStatus::Ok;
+  }
+  for (UINT gestureIdx = 0; gestureIdx < _numOfGestures; ++gestureIdx) {
+    auto& wrapped_gesture = wrapped_body.gestures[gestureIdx];
+    GestureType gestureType;
+    if (FAILED(source.GetGestureType(gestureIdx, gestureType))) {
+      return FKinectBodyStatus::GestureFailed;
+    }
+    wrapped_gesture.type = static_cast<decltype(wrapped_gesture.type)>(gestureType);
+    if (gestureType == GestureType::GestureType_Discrete) {
+      wchar_t gestureName[260];
+      if (FAILED(source.GetGestureName(gestureIdx, gestureName))) {
+        return FKinectBodyStatus::GestureFailed;
+      }
+      wrapped_gesture.name = FString(gestureName);
+      bool bDetected = false;
+      float confidence = 0.0f;
+      if (FAILED(source.GetDiscreteGestureResult(bodyIndex, gestureIdx, bDetected, confidence))) {
+        return FKinectBodyStatus::GestureFailed;
+      }
+      wrapped_gesture.bDetected = bDetected;
+      if (bDetected) {
+        wrapped_gesture.confidence = confidence;
+
+        //if (confidence > 0.8f) {
+          UE_LOG(LogTemp, Verbose, TEXT("Gesture: %s          confidence: %f"), gestureName, confidence);
+        //}
+      }
+    } else if (gestureType == GestureType::GestureType_Continuous) {
+
+    } else {
+      check(false);
+      return FKinectBodyStatus::GestureFailed;
+    }
+  }
+  return FKinectBodyStatus::Ok;
+}
+
+void FKinectUE4Module::InstallBodyFrameSource(const TSharedPtr<IKinectBodyFrameSource>& source, UINT numOfGestures) {
+  _bodyFrameSource = source;
+  _numOfGestures = numOfGestures;
+  for (int i = 0; i < BODY_COUNT; ++i) {
+    _bodies[i].gestures.SetNum(numOfGestures, true);
+  }
+
+  FRWScopeLock lock(_poseFramesLock, SLT_Write);
+  _numOfPoseFrames = 0;
+}
+
+void FKinectUE4Module::PublishPoseFrame(double sensorTime, double engineTime) {
+  FRWScopeLock lock(_poseFramesLock, SLT_Write);
+
+  // Frames reach us late by a varying amount, so the smallest offset seen is the best estimate of the clock
+  // difference. Let it creep up slowly so drift between the two clocks is still followed. Frames keep their
+  // sensor time and the offset is applied when sampling, so every kept frame shares one mapping.
+  const double sensorToEngineTime = engineTime - sensorTime;
+  if (_numOfPoseFrames == 0 || sensorToEngineTime < _sensorToEngineTime) {
+    _sensorToEngineTime = sensorToEngineTime;
+  } else {
+    _sensorToEngineTime += (sensorToEngineTime - _sensorToEngineTime) * 0.001;
+  }
+
+  const int frameIndex = _numOfPoseFrames == 0 ? 0 : (_latestPoseFrame + 1) % FKinectPoseFrame::Max;
+  auto& frame = _poseFrames[frameIndex];
+  frame.sensorTime = sensorTime;
+  CopyBodyPoses(_bodies, frame.poses);
+  _latestPoseFrame = frameIndex;
+  _numOfPoseFrames = FMath::Min(_numOfPoseFrames + 1, FKinectPoseFrame::Max);
+}
+
+bool FKinectUE4Module::SampleBodyPoses(double time, FKinectBodyPose (&out_poses)[FKinectBody::Count]) const {
+  FRWScopeLock lock(_poseFramesLock, SLT_ReadOnly);
+  if (_numOfPoseFrames == 0) {
     return false;
   }
-  IBody* tmp_bodies[BODY_COUNT] = { nullptr };
-  if (FAILED(bodyFrame->GetAndRefreshBodyData(BODY_COUNT, tmp_bodies))) {
-    UE_LOG(LogTemp, Error, TEXT("FAILED(bodyFrame->GetAndRefreshBodyData(BODY_COUNT, tmp_bodies))"));
+  auto poseFrame = [this](int age) -> const FKinectPoseFrame& {
+    return _poseFrames[(_latestPoseFrame - age + FKinectPoseFrame::Max) % FKinectPoseFrame::Max];
+  };
+  if (_numOfPoseFrames == 1) {
+    const auto& newest = poseFrame(0);
+    std::copy(std::begin(newest.poses), std::end(newest.poses), std::begin(out_poses));
+    return true;
+  }
+  // Walk back to the newest pair whose older frame is at or before time; stop at the oldest pair.
+  const double sensorTime = time - _sensorToEngineTime;
+  int age = 1;
+  while (age < _numOfPoseFrames - 1 && poseFrame(age).sensorTime > sensorTime) {
+    ++age;
+  }
+  const auto& older = poseFrame(age);
+  const auto& newer = poseFrame(age - 1);
+  const double span = newer.sensorTime - older.sensorTime;
+  float alpha = 1.f;
+  if (span > SMALL_NUMBER) {
+    // Only the newest pair may extrapolate; inside the buffer the pair found brackets time.
+    const double maxAlpha = age == 1 ? 1.0 + CVarKinectMaxExtrapolationSeconds.GetValueOnAnyThread() / span : 1.0;
+    alpha = (float)FMath::Clamp((sensorTime - older.sensorTime) / span, 0.0, maxAlpha);
+  }
+
+  for (int i = 0; i < FKinectBody::Count; ++i) {
+    const auto& from = older.poses[i];
+    const auto& to = newer.poses[i];
+    auto& out_pose = out_poses[i];
+    // A body slot can be handed to another person between frames; never blend across that.
+    if (!to.bValid || !from.bValid || from.trackingId != to.trackingId) {
+      out_pose = to;
+      continue;
+    }
+    out_pose.bValid = true;
+    out_pose.trackingId = to.trackingId;
+    for (int j = 0; j < FKinectJoint::TypeCount; ++j) {
+      const auto& from_joint = from.joints[j];
+      const auto& to_joint = to.joints[j];
+      auto& out_joint = out_pose.joints[j];
+      out_joint.type = to_joint.type;
+      out_joint.trackingState = to_joint.trackingState;
+      out_joint.location = FMath::Lerp(from_joint.location, to_joint.location, alpha);
+      out_joint.orientation = FQuat::Slerp(from_joint.orientation, to_joint.orientation, alpha);
+    }
+  }
+  return true;
+}
+
+void FKinectUE4Module::BeginBodyFrameRecording() {
+  _bodyFrameRecording = BodyFrameRecordingHeader;
+  _bodyFrameRecording += LINE_TERMINATOR;
+  _numOfRecordedFrames = 0;
+  bRecordingBodyFrames = true;
+}
+
+bool FKinectUE4Module::EndBodyFrameRecording(const FString& filePath) {
+  if (!bRecordingBodyFrames) {
     return false;
   }
-  for (int i = 0; i < BODY_COUNT; ++i) {
-    bodies[i] = tmp_bodies[i];
+  bRecordingBodyFrames = false;
+  const bool bSaved = FFileHelper::SaveStringToFile(_bodyFrameRecording, *filePath);
+  if (!bSaved) {
+    UE_LOG(LogTemp, Error, TEXT("FAILED(FFileHelper::SaveStringToFile(_bodyFrameRecording, \"%s\"))"), *filePath);
+  } else {
+    UE_LOG(LogTemp, Log, TEXT("Recorded %u body frames to %s"), _numOfRecordedFrames, *filePath);
   }
-  for (int i = 0; i < BODY_COUNT; ++i) {
-    const TKinectComPtr<IBody>& body = bodies[i];
-    if (body) {
-      BOOLEAN bTracked = false;
-      if (FAILED(body->get_IsTracked(&bTracked))) {
-        UE_LOG(LogTemp, Error, TEXT("FAILED(body->get_IsTracked(&bTracked))"));
-        return false;
+  _bodyFrameRecording.Empty();
+  return bSaved;
+}
+
+struct FKinectBenchmarkFrame {
+  int numOfBodies = 0;
+  Joint joints[BODY_COUNT][JointType_Count];
+  JointOrientation orientations[BODY_COUNT][JointType_Count];
+};
+
+static void MakeSyntheticBenchmarkFrames(int32 numOfFrames, TArray<FKinectBenchmarkFrame>& out_frames) {
+  out_frames.SetNum(numOfFrames);
+  for (int32 f = 0; f < numOfFrames; ++f) {
+    auto& frame = out_frames[f];
+    frame.numOfBodies = BODY_COUNT;
+    const float time = f / 30.f;
+    for (int i = 0; i < BODY_COUNT; ++i) {
+      for (int j = 0; j < JointType_Count; ++j) {
+        auto& joint = frame.joints[i][j];
+        joint.JointType = static_cast<JointType>(j);
+        joint.TrackingState = (j + f) % 7 == 0 ? TrackingState_Inferred : TrackingState_Tracked;
+        joint.Position.X = -1.5f + 0.6f * i + 0.1f * FMath::Sin(time + j);
+        joint.Position.Y = -0.9f + 0.07f * j + 0.05f * FMath::Cos(time * 2.f + i);
+        joint.Position.Z = 2.5f + 0.2f * FMath::Sin(time * 0.5f + i);
+        auto& orientation = frame.orientations[i][j];
+        orientation.JointType = static_cast<JointType>(j);
+        const float halfAngle = 0.25f * FMath::Sin(time + i + j);
+        orientation.Orientation.x = 0.f;
+        orientation.Orientation.y = FMath::Sin(halfAngle);
+        orientation.Orientation.z = 0.f;
+        orientation.Orientation.w = FMath::Cos(halfAngle);
       }
-      auto& wrapped_body = _bodies[i];
-      wrapped_body.bValid = (bool)bTracked;
-      if (bTracked) {
-        if (bAcquireJoint) { // Joint
-          Joint joints[JointType_Count];
-          if (FAILED(body->GetJoints(JointType_Count, joints))) {
-            UE_LOG(LogTemp, Error, TEXT("FAILED(body->GetJoints(JointType_Count, joints))"));
-            return false;
-          }
-          for (int j = 0; j < JointType_Count; ++j) {
-            const auto& joint = joints[j];
-            auto& wrapped_joint = wrapped_body.joints[j];
-            wrapped_joint.type = static_cast<decltype(wrapped_joint.type)>(joint.JointType);
-            wrapped_joint.trackingState = static_cast<decltype(wrapped_joint.trackingState)>(joint.TrackingState);
-            wrapped_joint.location = FVector(joint.Position.Z, -joint.Position.X, joint.Position.Y) * 100.f;
-          }
-        }
-        if (bAcquireGesture) { // Gesture
-          for (UINT gestureIdx = 0; gestureIdx < _numOfGestures; ++gestureIdx) {
-            wrapped_body.gestures[gestureIdx].Reset();
-          }
-          UINT64 trackingId = _UI64_MAX;
-          if (FAILED(body->get_TrackingId(&trackingId))) {
-            UE_LOG(LogTemp, Error, TEXT("FAILED(body->get_TrackingId(&trackingId))"));
-            return false;
-          }
-          UINT64 gestureId = _UI64_MAX;
-          if (FAILED(_gestureSources[i]->get_TrackingId(&gestureId))) {
-            UE_LOG(LogTemp, Error, TEXT("FAILED(_gestureSources[i]->get_TrackingId(&gestureId))"));
-            return false;
-          }
-          if (trackingId != gestureId) {
-            if (FAILED(_gestureSources[i]->put_TrackingId(trackingId))) {
-              UE_LOG(LogTemp, Error, TEXT("FAILED(_gestureSources[i]->put_TrackingId(trackingId))"));
-              return false;
-            }
-            UE_LOG(LogTemp, Error, TEXT("Put TrackingId: %llu"), trackingId);
-            //continue;
-          }
-          TKinectComPtr<IVisualGestureBuilderFrame> gestureFrame;
-          hr = _gestureReaders[i]->CalculateAndAcquireLatestFrame(&gestureFrame);
-          if (hr == E_PENDING) {
-            return false;
-          } else if (FAILED(hr)) {
-            UE_LOG(LogTemp, Error, TEXT("FAILED(_gestureReaders[i]->CalculateAndAcquireLatestFrame(&gestureFrame))"));
-            return false;
-          }
-          BOOLEAN bGestureTracked = false;
-          if (FAILED(gestureFrame->get_IsTrackingIdValid(&bGestureTracked))) {
-            UE_LOG(LogTemp, Error, TEXT("FAILED(gestureFrame->get_IsTrackingIdValid(&bGestureTracked))"));
-            return false;
-          }
-          if (bGestureTracked) {
-            static int oN = 1;
-            UE_LOG(LogTemp, Log, TEXT("In ----------------- %d"), oN++);
-
-            for (UINT gestureIdx = 0; gestureIdx < _numOfGestures; ++gestureIdx) {
-              auto& wrapped_gesture = wrapped_body.gestures[gestureIdx];
-              GestureType gestureType;
-              if (FAILED(_gestures[gestureIdx]->get_GestureType(&gestureType))) {
-                UE_LOG(LogTemp, Error, TEXT("FAILED(_gestures[gestureIdx]->get_GestureType(&gestureType))"));
-                return false;
-              }
-              wrapped_gesture.type = static_cast<decltype(wrapped_gesture.type)>(gestureType);
-              if (gestureType == GestureType::GestureType_Discrete) {
-                TKinectComPtr<IDiscreteGestureResult> gestureResult = nullptr;
-                if (FAILED(gestureFrame->get_DiscreteGestureResult(_gestures[gestureIdx].Get(), &gestureResult))) {
-                  UE_LOG(LogTemp, Error, TEXT("FAILED(gestureFrame->get_DiscreteGestureResult(_gestures[gestureIdx], &gestureResult))"));
-                  return false;
-                }
-                wchar_t gestureName[260];
-                if (FAILED(_gestures[gestureIdx]->get_Name(260, gestureName))) {
-                  UE_LOG(LogTemp, Error, TEXT("FAILED(_gestures[gestureIdx]->get_Name(260, gestureName))"));
-                  return false;
-                }
-                wrapped_gesture.name = FString(gestureName);
-                BOOLEAN detected = false;
-                if (FAILED(gestureResult->get_Detected(&detected))) {
-                  UE_LOG(LogTemp, Error, TEXT("FAILED(gestureResult->get_Detected(&detected))"));
-                  return false;
-                }
-                wrapped_gesture.bDetected = detected;
-                if (detected) {
-                  float confidence = 0.0f;
-                  if (FAILED(gestureResult->get_Confidence(&confidence))) {
-                    UE_LOG(LogTemp, Error, TEXT("FAILED(gestureResult->get_Confidence(&confidence))"));
-                    return false;
-                  }
-                  wrapped_gesture.confidence = confidence;
-
-                  //if (confidence > 0.8f) {
-                    UE_LOG(LogTemp, Log, TEXT("Gesture: %s          confidence: %f"), gestureName, confidence);
-                  //}
-                }
-              } else if (gestureType == GestureType::GestureType_Continuous) {
-
-              } else {
-                check(false);
-                return false;
-              }
-            }
-          }
-        }
+    }
+  }
+}
+
+static bool LoadRecordedBenchmarkFrames(const FString& filePath, TArray<FKinectBenchmarkFrame>& out_frames) {
+  TArray<FString> lines;
+  if (!FFileHelper::LoadFileToStringArray(lines, *filePath)) {
+    UE_LOG(LogTemp, Error, TEXT("FAILED(FFileHelper::LoadFileToStringArray(lines, \"%s\"))"), *filePath);
+    return false;
+  }
+  if (lines.Num() == 0 || lines[0].TrimEnd() != BodyFrameRecordingHeader) {
+    UE_LOG(LogTemp, Error, TEXT("%s is not a body frame recording, expected \"%s\" on the first line"), *filePath, BodyFrameRecordingHeader);
+    return false;
+  }
+  const int numOfJointFields = 8;
+  TMap<uint32, int32> frameIndices;
+  TArray<FString> fields;
+  for (const FString& line : lines) {
+    line.ParseIntoArrayWS(fields);
+    if (fields.Num() != 2 + JointType_Count * numOfJointFields) {
+      continue;
+    }
+    const uint32 frameIndex = (uint32)FCString::Atoi64(*fields[0]);
+    const int32* existing = frameIndices.Find(frameIndex);
+    auto& frame = out_frames[existing ? *existing : frameIndices.Add(frameIndex, out_frames.AddDefaulted())];
+    if (frame.numOfBodies == BODY_COUNT) {
+      continue;
+    }
+    auto& joints = frame.joints[frame.numOfBodies];
+    auto& orientations = frame.orientations[frame.numOfBodies];
+    ++frame.numOfBodies;
+    for (int j = 0; j < JointType_Count; ++j) {
+      const FString* jointFields = &fields[2 + j * numOfJointFields];
+      joints[j].JointType = static_cast<JointType>(j);
+      joints[j].TrackingState = static_cast<TrackingState>(FCString::Atoi(*jointFields[0]));
+      joints[j].Position.X = FCString::Atof(*jointFields[1]);
+      joints[j].Position.Y = FCString::Atof(*jointFields[2]);
+      joints[j].Position.Z = FCString::Atof(*jointFields[3]);
+      orientations[j].JointType = static_cast<JointType>(j);
+      orientations[j].Orientation.x = FCString::Atof(*jointFields[4]);
+      orientations[j].Orientation.y = FCString::Atof(*jointFields[5]);
+      orientations[j].Orientation.z = FCString::Atof(*jointFields[6]);
+      orientations[j].Orientation.w = FCString::Atof(*jointFields[7]);
+    }
+  }
+  if (out_frames.Num() == 0) {
+    UE_LOG(LogTemp, Error, TEXT("No body frames in %s"), *filePath);
+    return false;
+  }
+  return true;
+}
+
+// Stands in for the sensor in RunBodyFrameBenchmark: replays frames at 30 Hz, tracks the first numOfBodies bodies
+// and spins for gestureReaderSeconds in place of CalculateAndAcquireLatestFrame.
+class FKinectFakeBodyFrameSource : public IKinectBodyFrameSource {
+public:
+  FKinectFakeBodyFrameSource(const TArray<FKinectBenchmarkFrame>& frames, int numOfBodies, double gestureReaderSeconds) :
+    _frames(frames),
+    _numOfBodies(numOfBodies),
+    _gestureReaderSeconds(gestureReaderSeconds)
+  {
+  }
+
+  virtual HRESULT AcquireLatestFrame(TIMESPAN& out_relativeTime) override {
+    ++_frameIndex;
+    out_relativeTime = (TIMESPAN)_frameIndex * 10000000 / 30;
+    return S_OK;
+  }
+
+  virtual HRESULT GetIsTracked(int bodyIndex, bool& out_bTracked) override {
+    out_bTracked = bodyIndex < _numOfBodies;
+    return S_OK;
+  }
+
+  virtual HRESULT GetTrackingId(int bodyIndex, UINT64& out_trackingId) override {
+    out_trackingId = bodyIndex + 1;
+    return S_OK;
+  }
+
+  virtual HRESULT GetJoints(int bodyIndex, Joint (&out_joints)[JointType_Count],
+                            JointOrientation (&out_orientations)[JointType_Count]) override {
+    const auto& frame = _frames[_frameIndex % _frames.Num()];
+    const int recordedBodyIndex = bodyIndex % frame.numOfBodies;
+    std::copy(std::begin(frame.joints[recordedBodyIndex]), std::end(frame.joints[recordedBodyIndex]), std::begin(out_joints));
+    std::copy(std::begin(frame.orientations[recordedBodyIndex]), std::end(frame.orientations[recordedBodyIndex]),
+              std::begin(out_orientations));
+    return S_OK;
+  }
+
+  virtual HRESULT AcquireGestureFrame(int bodyIndex, UINT64 trackingId, bool& out_bTrackingIdValid) override {
+    if (_gestureReaderSeconds > 0.0) {
+      const double readerEndTime = FPlatformTime::Seconds() + _gestureReaderSeconds;
+      while (FPlatformTime::Seconds() < readerEndTime) {
       }
-    } else {
-      _bodies[i].bValid = false;
     }
+    out_bTrackingIdValid = true;
+    return S_OK;
   }
-  out_bodies = _bodies;
+
+  virtual HRESULT GetGestureType(UINT gestureIndex, GestureType& out_type) override {
+    out_type = GestureType_Discrete;
+    return S_OK;
+  }
+
+  virtual HRESULT GetGestureName(UINT gestureIndex, wchar_t (&out_name)[260]) override {
+    FCString::Snprintf(out_name, 260, TEXT("Gesture_%02u"), gestureIndex);
+    return S_OK;
+  }
+
+  virtual HRESULT GetDiscreteGestureResult(int bodyIndex, UINT gestureIndex, bool& out_bDetected, float& out_confidence) override {
+    out_bDetected = (_frameIndex + bodyIndex + gestureIndex) % 4 == 0;
+    out_confidence = out_bDetected ? 0.5f + 0.1f * (gestureIndex % 5) : 0.f;
+    return S_OK;
+  }
+
+private:
+  const TArray<FKinectBenchmarkFrame>& _frames;
+  int _numOfBodies;
+  double _gestureReaderSeconds;
+  uint32 _frameIndex = 0;
+};
+
+// Installed as GMalloc for the timed run of BenchmarkBodyFrames. Counts Malloc and Realloc calls from every thread
+// and forwards everything to the allocator it replaced.
+class FKinectCountingMalloc : public FMalloc {
+public:
+  explicit FKinectCountingMalloc(FMalloc* inner) :
+    _inner(inner)
+  {
+  }
+
+  virtual void* Malloc(SIZE_T count, uint32 alignment) override {
+    _numOfAllocs.Increment();
+    return _inner->Malloc(count, alignment);
+  }
+
+  virtual void* Realloc(void* original, SIZE_T count, uint32 alignment) override {
+    _numOfAllocs.Increment();
+    return _inner->Realloc(original, count, alignment);
+  }
+
+  virtual void Free(void* original) override {
+    _inner->Free(original);
+  }
+
+  virtual SIZE_T QuantizeSize(SIZE_T count, uint32 alignment) override {
+    return _inner->QuantizeSize(count, alignment);
+  }
+
+  virtual bool GetAllocationSize(void* original, SIZE_T& out_size) override {
+    return _inner->GetAllocationSize(original, out_size);
+  }
+
+  virtual void Trim() override {
+    _inner->Trim();
+  }
+
+  virtual void SetupTLSCachesOnCurrentThread() override {
+    _inner->SetupTLSCachesOnCurrentThread();
+  }
+
+  virtual void ClearAndDisableTLSCachesOnCurrentThread() override {
+    _inner->ClearAndDisableTLSCachesOnCurrentThread();
+  }
+
+  virtual bool IsInternallyThreadSafe() const override {
+    return _inner->IsInternallyThreadSafe();
+  }
+
+  virtual bool ValidateHeap() override {
+    return _inner->ValidateHeap();
+  }
+
+  virtual const TCHAR* GetDescriptiveName() override {
+    return _inner->GetDescriptiveName();
+  }
+
+  int32 GetNumOfAllocs() const {
+    return _numOfAllocs.GetValue();
+  }
+
+private:
+  FMalloc* _inner;
+  FThreadSafeCounter _numOfAllocs;
+};
+
+struct FKinectBenchmarkResult {
+  double nsPerFrame = 0.0;
+  double allocsPerFrame = 0.0;
+};
+
+static FKinectBenchmarkResult BenchmarkBodyFrames(FKinectUE4Module& module, int32 numOfFrames) {
+  FKinectBody* bodies = nullptr;
+  auto runFrames = [&]() {
+    for (int32 f = 0; f < numOfFrames; ++f) {
+      module.AcquireLatestBodyFrame(bodies, true, true);
+    }
+  };
+
+  runFrames(); // warm up
+
+  // Other engine threads allocate too, so run the benchmark with the game otherwise idle.
+  FMalloc* malloc = GMalloc;
+  FKinectCountingMalloc countingMalloc(malloc);
+  GMalloc = &countingMalloc;
+  const uint64 startCycles = FPlatformTime::Cycles64();
+  runFrames();
+  const uint64 cycles = FPlatformTime::Cycles64() - startCycles;
+  GMalloc = malloc;
+
+  FKinectBenchmarkResult result;
+  result.nsPerFrame = FPlatformTime::GetSecondsPerCycle64() * cycles * 1e9 / numOfFrames;
+  result.allocsPerFrame = (double)countingMalloc.GetNumOfAllocs() / numOfFrames;
+  return result;
+}
+
+bool FKinectUE4Module::RunBodyFrameBenchmark(int32 numOfFrames, const FString& recordingFilePath, float gestureReaderMicroseconds) {
+  if (numOfFrames <= 0) {
+    UE_LOG(LogTemp, Error, TEXT("numOfFrames <= 0"));
+    return false;
+  }
+
+  TArray<FKinectBenchmarkFrame> frames;
+  const bool bRecorded = !recordingFilePath.IsEmpty();
+  if (bRecorded) {
+    if (!LoadRecordedBenchmarkFrames(recordingFilePath, frames)) {
+      return false;
+    }
+  } else {
+    MakeSyntheticBenchmarkFrames(FMath::Min(numOfFrames, 300), frames);
+  }
+
+  FString pluginVersion = TEXT("unknown");
+  TSharedPtr<IPlugin> plugin = IPluginManager::Get().FindPlugin(TEXT("KinectUE4"));
+  if (plugin.IsValid()) {
+    pluginVersion = plugin->GetDescriptor().VersionName;
+  }
+  const FString input = bRecorded ? FPaths::GetCleanFilename(recordingFilePath) : FString(TEXT("synthetic"));
+
+  FString csv = TEXT("PluginVersion,Input,Parallel,ReaderUs,Bodies,Gestures,Frames,NsPerFrame,NsPerBody,AllocsPerFrame") LINE_TERMINATOR;
+  for (int parallel = 0; parallel <= 1; ++parallel) {
+    for (int numOfBodies = 1; numOfBodies <= FKinectBody::Count; ++numOfBodies) {
+      for (int numOfGestures = 1; numOfGestures <= FKinectGesture::Max; numOfGestures *= 2) {
+        TUniquePtr<FKinectUE4Module> module = MakeUnique<FKinectUE4Module>();
+        module->_parallelBodies = parallel;
+        module->InstallBodyFrameSource(
+          MakeShared<FKinectFakeBodyFrameSource>(frames, numOfBodies, gestureReaderMicroseconds * 1e-6), numOfGestures);
+        const auto result = BenchmarkBodyFrames(*module, numOfFrames);
+        csv += FString::Printf(TEXT("%s,%s,%d,%.1f,%d,%d,%d,%.1f,%.1f,%.2f") LINE_TERMINATOR, *pluginVersion, *input,
+                               parallel, gestureReaderMicroseconds, numOfBodies, numOfGestures, numOfFrames,
+                               result.nsPerFrame, result.nsPerFrame / numOfBodies, result.allocsPerFrame);
+        UE_LOG(LogTemp, Log, TEXT("BodyFrameBenchmark: parallel=%d bodies=%d gestures=%d %.1f ns/frame %.2f allocs/frame"),
+               parallel, numOfBodies, numOfGestures, result.nsPerFrame, result.allocsPerFrame);
+      }
+    }
+  }
+
+  const FString filePath = FPaths::ProfilingDir() / TEXT("KinectUE4") /
+    FString::Printf(TEXT("BodyFrameBenchmark-%s.csv"), *FDateTime::Now().ToString());
+  if (!FFileHelper::SaveStringToFile(csv, *filePath)) {
+    UE_LOG(LogTemp, Error, TEXT("FAILED(FFileHelper::SaveStringToFile(csv, \"%s\"))"), *filePath);
+    return false;
+  }
+  UE_LOG(LogTemp, Log, TEXT("BodyFrameBenchmark written to %s"), *filePath);
   return true;
 }
 
+static FAutoConsoleCommand GKinectBenchmarkBodyFrameCommand(
+  TEXT("Kinect.BenchmarkBodyFrame"),
+  TEXT("Kinect.BenchmarkBodyFrame [NumOfFrames=1000] [RecordingFile|synthetic] [GestureReaderMicroseconds=0]: ")
+  TEXT("times the body path for 1..6 bodies and 1..16 gestures, serial and parallel"),
+  FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& args) {
+    const int32 numOfFrames = args.Num() > 0 ? FCString::Atoi(*args[0]) : 1000;
+    const FString recordingFilePath = args.Num() > 1 && args[1] != TEXT("synthetic") ? args[1] : FString();
+    const float gestureReaderMicroseconds = args.Num() > 2 ? FCString::Atof(*args[2]) : 0.f;
+    FKinectUE4Module::RunBodyFrameBenchmark(numOfFrames, recordingFilePath, gestureReaderMicroseconds);
+  }));
+
+static FAutoConsoleCommand GKinectBeginBodyFrameRecordingCommand(
+  TEXT("Kinect.BeginBodyFrameRecording"),
+  TEXT("Kinect.BeginBodyFrameRecording: starts recording the joints acquired by AcquireLatestBodyFrame"),
+  FConsoleCommandDelegate::CreateLambda([]() {
+    FModuleManager::LoadModuleChecked<FKinectUE4Module>(TEXT("KinectUE4")).BeginBodyFrameRecording();
+  }));
+
+static FAutoConsoleCommand GKinectEndBodyFrameRecordingCommand(
+  TEXT("Kinect.EndBodyFrameRecording"),
+  TEXT("Kinect.EndBodyFrameRecording <File>: stops recording and saves it for Kinect.BenchmarkBodyFrame"),
+  FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& args) {
+    const FString filePath = args.Num() > 0 ? args[0] : FPaths::ProfilingDir() / TEXT("KinectUE4") / TEXT("BodyFrames.txt");
+    FModuleManager::LoadModuleChecked<FKinectUE4Module>(TEXT("KinectUE4")).EndBodyFrameRecording(filePath);
+  }));
+
 //bool FKinectUE4Module::AcquireLatestGestureFrame() {
 //  if (!_bodyFrameReader) {
 //    return false;
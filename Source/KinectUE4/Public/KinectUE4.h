@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "HAL/CriticalSection.h"
 
 
 //#ifndef WIN32_LEAN_AND_MEAN
@@ -57,12 +58,22 @@ enum class FKinectGestureType {
   Continuous = 2
 };
 
+class IKinectBodyFrameSource;
+
+enum class FKinectBodyStatus {
+  Ok = 0,
+  Pending = 1, // gesture results not ready for this frame, joints are still valid
+  Failed = 2, // body could not be read, bValid is false
+  GestureFailed = 3 // gesture results could not be read, joints are still valid
+};
+
 struct FKinectJoint {
   static constexpr int TypeCount = 25;
 
   FKinectJointType type;
   FKinectTrackingState trackingState;
   FVector location;
+  FQuat orientation = FQuat::Identity;
 };
 
 struct FKinectGesture {
@@ -85,9 +96,17 @@ struct FKinectBody {
   static constexpr int Count = 6;
 
   bool bValid = false;
+  FKinectBodyStatus status = FKinectBodyStatus::Ok;
+  uint64 trackingId = 0;
   FKinectJoint joints[FKinectJoint::TypeCount];
   TArray<FKinectGesture> gestures;
 };
+
+struct FKinectBodyPose {
+  bool bValid = false;
+  uint64 trackingId = 0;
+  FKinectJoint joints[FKinectJoint::TypeCount];
+};
 //
 //template<typename T>
 //struct TKinectDefaultUnrefer {};
@@ -229,6 +248,27 @@ public:
   bool AcquireLatestBodyFrame(FKinectBody*& out_bodies, bool bAcquireJoint = true, bool bAcquireGesture = false);
   //bool AcquireLatestGestureFrame();
 
+  /** Records the raw joints seen by AcquireLatestBodyFrame so they can be replayed by RunBodyFrameBenchmark. */
+  void BeginBodyFrameRecording();
+  bool EndBodyFrameRecording(const FString& filePath);
+
+  /**
+   * Runs AcquireLatestBodyFrame against a fake sensor for 1..6 tracked bodies and 1..16 gestures, and writes
+   * the results as CSV under the profiling directory. The fake replays synthetic joints unless recordingFilePath
+   * points to a file written by EndBodyFrameRecording. Each configuration runs serially and in parallel;
+   * gestureReaderMicroseconds is the fake gesture reader's cost per body.
+   */
+  static bool RunBodyFrameBenchmark(int32 numOfFrames, const FString& recordingFilePath = FString(),
+                                    float gestureReaderMicroseconds = 0.f);
+
+  /**
+   * Samples the joints at an engine time (FPlatformTime::Seconds() clock), interpolating between the two
+   * recent sensor frames that bracket it, or extrapolating past the newest one by at most
+   * Kinect.MaxExtrapolationSeconds. Times before the oldest kept frame return that frame.
+   * Only fills poses from frames acquired with bAcquireJoint. Safe to call from any thread.
+   */
+  bool SampleBodyPoses(double time, FKinectBodyPose (&out_poses)[FKinectBody::Count]) const;
+
 public:
   bool bKinectStartup = false;
   TKinectUniqueComPtr<struct IKinectSensor, TKinectDefaultReferWithClose<struct IKinectSensor>> _kinectSensor;
@@ -241,5 +281,29 @@ public:
   TKinectComPtr<struct IVisualGestureBuilderFrameReader> _gestureReaders[FKinectBody::Count];
 
 private:
+  struct FKinectPoseFrame {
+    static constexpr int Max = 4;
+
+    double sensorTime = 0.0;
+    FKinectBodyPose poses[FKinectBody::Count];
+  };
+
+  void InstallBodyFrameSource(const TSharedPtr<IKinectBodyFrameSource>& source, UINT numOfGestures);
+  FKinectBodyStatus AcquireBody(IKinectBodyFrameSource& source, int bodyIndex, bool bAcquireJoint, bool bAcquireGesture,
+                                FString* out_recording);
+  void PublishPoseFrame(double sensorTime, double engineTime);
+
+  TSharedPtr<IKinectBodyFrameSource> _bodyFrameSource;
+  int32 _parallelBodies = -1; // overrides Kinect.ParallelBodies when >= 0
   FKinectBody _bodies[FKinectBody::Count];
+
+  mutable FRWLock _poseFramesLock;
+  FKinectPoseFrame _poseFrames[FKinectPoseFrame::Max];
+  int _latestPoseFrame = 0;
+  int _numOfPoseFrames = 0;
+  double _sensorToEngineTime = 0.0; // guarded by _poseFramesLock
+
+  bool bRecordingBodyFrames = false;
+  uint32 _numOfRecordedFrames = 0;
+  FString _bodyFrameRecording;
 };